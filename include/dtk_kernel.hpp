@@ -3,6 +3,7 @@
 
 #include <string>
 #define MAX_NODES 2
+#define DTK_INGEST_RECORD_SIZE 32
 
 typedef enum taskType {
     JOB_A,
@@ -100,6 +101,45 @@ bool isTaskQueueEmpty(task* head);
  */
 void cleanUpTaskQueue(task* head);
 
+/**
+ * @brief Appends an already linked list of tasks to the end of the queue in a
+ * single operation, instead of calling enqueueTask() once per task.
+ * @param head The current head of the task queue.
+ * @param listHead The first task of the list to be appended.
+ * @param listTail The last task of the list to be appended; its 'next' link is
+ * reset to nullptr.
+ * @return task* The (potentially new) head of the task queue.
+ */
+task* spliceTaskList(task* head, task* listHead, task* listTail);
+
+/* Ingest handlers */
+
+/**
+ * @brief Bulk loads tasks from a submission file into the task queue. The file
+ * is memory mapped and parsed in parallel chunks, one per hardware thread,
+ * and the resulting tasks are spliced into the queue in one operation.
+ *
+ * Two file formats are accepted:
+ *  - text: one task per line, "[submit] <TaskType> <InputData>". Blank lines
+ *    and lines starting with '#' are ignored.
+ *  - binary: the magic "DTKB" followed by fixed DTK_INGEST_RECORD_SIZE byte
+ *    records; byte 0 is the taskType value and the remaining bytes hold the
+ *    NUL padded input data.
+ *
+ * Malformed lines/records are skipped and reported. Task IDs and simulated
+ * work units are assigned in file order, continuing from the given counters.
+ * @param currentTaskQueueHead The current head of the global task queue.
+ * @param filePath Path of the submission file.
+ * @param nextTaskID Next task ID to hand out; advanced past the ingested tasks.
+ * @param nextWorkUnits Next simulated work units value; advanced likewise.
+ * @param threadCount Number of parser threads, 0 uses one per hardware thread.
+ * Files too small to split are always parsed by fewer threads.
+ * @return task* The updated head of the task queue. On failure the queue is
+ * left unchanged.
+ */
+task *dtkIngest(task *currentTaskQueueHead, const std::string &filePath,
+                int *nextTaskID, int *nextWorkUnits, unsigned int threadCount = 0);
+
 /* system handlers */
 
 /**
@@ -83,3 +83,28 @@ void cleanUpTaskQueue(task* head) {
 
     std::cout << "[INFO]: All Tasks deleted !\n";
 }
+
+/* @breif Appends a linked list of tasks to the end of the queue at once.
+ * The existing queue is walked a single time to find its tail, so a bulk
+ * load costs O(queue + list) rather than one full walk per task.
+ * @head: The current head of the task queue.
+ * @listHead: The first task of the list to be appended.
+ * @listTail: The last task of the list to be appended.
+ * @Return: task* - The (potentially new) head of the task queue.
+ */
+task* spliceTaskList(task* head, task* listHead, task* listTail) {
+    if(listHead == nullptr)
+        return head;
+
+    std::cout << "[INFO]: Task list splice in progress...\n";
+    listTail->next = nullptr;
+
+    if(head == nullptr)
+        return listHead;
+
+    task *current = head;
+    while(current->next != nullptr)
+        current = current->next;
+    current->next = listHead;
+    return head;
+}
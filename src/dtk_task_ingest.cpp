@@ -0,0 +1,410 @@
+#include "dtk_kernel.hpp"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INGEST_MAGIC "DTKB"
+#define INGEST_MAGIC_SIZE 4
+// smallest piece of a text file worth handing to its own thread
+#define INGEST_MIN_CHUNK_SIZE (64 * 1024)
+// how often (in bytes) a worker publishes its progress
+#define INGEST_PROGRESS_STEP (256 * 1024)
+// progress polling and reporting intervals of the calling thread
+#define INGEST_POLL_MS 5
+#define INGEST_REPORT_MS 250
+
+/* per thread parse result, tasks are linked in file order
+ * but IDs are only assigned once all chunks are joined.
+ * workers fill an ingestList on their own stack and store it
+ * here once, so neighbouring chunks in the vector do not
+ * bounce a shared cache line on every parsed task
+ */
+typedef struct ingestList {
+    task *head;
+    task *tail;
+    size_t accepted;
+    size_t rejected;
+} ingestList;
+
+typedef struct ingestChunk {
+    const char *begin;
+    const char *end;
+    task *head;
+    task *tail;
+    size_t accepted;
+    size_t rejected;
+    bool allocFailed;
+} ingestChunk;
+
+/* @breif: Maps a task type name (JOB_A .. JOB_D) to its enum value.
+ * @Return: bool - false if the name is not a supported task type.
+ */
+static bool parseTaskType(const char *name, size_t len, taskType *type) {
+    if(len != 5 || std::memcmp(name, "JOB_", 4) != 0)
+        return false;
+
+    switch (name[4]) {
+        case 'A': *type = JOB_A; return true;
+        case 'B': *type = JOB_B; return true;
+        case 'C': *type = JOB_C; return true;
+        case 'D': *type = JOB_D; return true;
+        default : return false;
+    }
+}
+
+/* @breif: Allocates a PENDING task and links it at the tail of the list.
+ * taskID and simulatedWorkUnits are filled in later, in file order.
+ * @Return: bool - false if memory allocation failed.
+ */
+static bool appendChunkTask(ingestList *list, taskType type,
+                            const char *data, size_t dataLen) {
+    task *newTask = new (std::nothrow) task;
+    if(newTask == nullptr)
+        return false;
+
+    newTask->taskID = 0;
+    newTask->task = type;
+    newTask->status = PENDING;
+    // data longer than the short string buffer allocates, and an
+    // exception escaping a worker thread would terminate the kernel
+    try {
+        newTask->inputData.assign(data, dataLen);
+    } catch (const std::bad_alloc &) {
+        delete newTask;
+        return false;
+    }
+    newTask->resultData = "";
+    newTask->simulatedProgress = 0;
+    newTask->simulatedWorkUnits = 0;
+    newTask->next = nullptr;
+
+    if(list->tail == nullptr)
+        list->head = newTask;
+    else
+        list->tail->next = newTask;
+    list->tail = newTask;
+    list->accepted++;
+    return true;
+}
+
+static inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/* @breif: Reads the next whitespace delimited token in [*cursor, end).
+ * @Return: size_t - length of the token, 0 if the line has no more tokens.
+ */
+static size_t nextToken(const char **cursor, const char *end, const char **token) {
+    const char *p = *cursor;
+    while(p < end && isBlank(*p))
+        p++;
+    *token = p;
+    while(p < end && !isBlank(*p))
+        p++;
+    *cursor = p;
+    return (size_t)(p - *token);
+}
+
+/* @breif: Stores a worker's parse result into its chunk in one go.
+ */
+static void storeChunkResult(ingestChunk *chunk, const ingestList *list, bool allocFailed) {
+    chunk->head = list->head;
+    chunk->tail = list->tail;
+    chunk->accepted = list->accepted;
+    chunk->rejected = list->rejected;
+    chunk->allocFailed = allocFailed;
+}
+
+/* @breif: Parses text lines "[submit] <TaskType> <InputData>" of one chunk.
+ * Chunk boundaries always sit on line starts, so no line is split between
+ * two threads.
+ */
+static void parseTextChunk(ingestChunk *chunk, std::atomic<size_t> *bytesParsed) {
+    const char *line = chunk->begin;
+    const char *lastReport = line;
+    ingestList list = {nullptr, nullptr, 0, 0};
+
+    while(line < chunk->end) {
+        const char *eol = static_cast<const char *>(
+                std::memchr(line, '\n', (size_t)(chunk->end - line)));
+        if(eol == nullptr)
+            eol = chunk->end;
+
+        const char *cursor = line;
+        const char *token = nullptr;
+        size_t len = nextToken(&cursor, eol, &token);
+
+        // blank lines and comments are not counted as rejected
+        if(len != 0 && token[0] != '#') {
+            if(len == 6 && std::memcmp(token, "submit", 6) == 0)
+                len = nextToken(&cursor, eol, &token);
+
+            taskType type;
+            const char *data = nullptr;
+            if(parseTaskType(token, len, &type)) {
+                size_t dataLen = nextToken(&cursor, eol, &data);
+                if(dataLen == 0) {
+                    list.rejected++;
+                } else if(!appendChunkTask(&list, type, data, dataLen)) {
+                    storeChunkResult(chunk, &list, true);
+                    return;
+                }
+            } else {
+                list.rejected++;
+            }
+        }
+
+        // a last line without a newline ends the chunk, stepping past it
+        // would point beyond the end of the mapping
+        if(eol == chunk->end)
+            break;
+        line = eol + 1;
+        if(line - lastReport >= INGEST_PROGRESS_STEP) {
+            bytesParsed->fetch_add((size_t)(line - lastReport), std::memory_order_relaxed);
+            lastReport = line;
+        }
+    }
+
+    if(chunk->end > lastReport)
+        bytesParsed->fetch_add((size_t)(chunk->end - lastReport), std::memory_order_relaxed);
+    storeChunkResult(chunk, &list, false);
+}
+
+/* @breif: Parses fixed size binary records of one chunk.
+ * byte 0 holds the taskType value, the rest is NUL padded input data.
+ */
+static void parseBinaryChunk(ingestChunk *chunk, std::atomic<size_t> *bytesParsed) {
+    const char *record = chunk->begin;
+    const char *lastReport = record;
+    ingestList list = {nullptr, nullptr, 0, 0};
+
+    for(; record + DTK_INGEST_RECORD_SIZE <= chunk->end; record += DTK_INGEST_RECORD_SIZE) {
+        unsigned char typeValue = (unsigned char)record[0];
+        const char *data = record + 1;
+        size_t dataLen = strnlen(data, DTK_INGEST_RECORD_SIZE - 1);
+
+        if(typeValue > JOB_D || dataLen == 0) {
+            list.rejected++;
+        } else if(!appendChunkTask(&list, (taskType)typeValue, data, dataLen)) {
+            storeChunkResult(chunk, &list, true);
+            return;
+        }
+
+        if(record - lastReport >= INGEST_PROGRESS_STEP) {
+            bytesParsed->fetch_add((size_t)(record - lastReport), std::memory_order_relaxed);
+            lastReport = record;
+        }
+    }
+
+    // a truncated trailing record can only be in the last chunk
+    if(record < chunk->end)
+        list.rejected++;
+
+    if(chunk->end > lastReport)
+        bytesParsed->fetch_add((size_t)(chunk->end - lastReport), std::memory_order_relaxed);
+    storeChunkResult(chunk, &list, false);
+}
+
+/* @breif: Splits [begin, end) into chunks for the parser threads.
+ * Text chunks are moved forward to the next line start, binary chunks are
+ * rounded to whole records.
+ */
+static void splitChunks(std::vector<ingestChunk> &chunks, const char *begin,
+                        const char *end, bool isBinary) {
+    size_t size = (size_t)(end - begin);
+    size_t count = chunks.size();
+    const char *previous = begin;
+
+    for(size_t i = 0; i < count; i++) {
+        const char *chunkEnd = end;
+        if(i + 1 < count) {
+            size_t offset = size / count * (i + 1);
+            if(isBinary) {
+                offset -= offset % DTK_INGEST_RECORD_SIZE;
+                chunkEnd = begin + offset;
+            } else {
+                chunkEnd = begin + offset;
+                while(chunkEnd > begin && chunkEnd < end && chunkEnd[-1] != '\n')
+                    chunkEnd++;
+            }
+            if(chunkEnd < previous)
+                chunkEnd = previous;
+        }
+
+        chunks[i].begin = previous;
+        chunks[i].end = chunkEnd;
+        chunks[i].head = nullptr;
+        chunks[i].tail = nullptr;
+        chunks[i].accepted = 0;
+        chunks[i].rejected = 0;
+        chunks[i].allocFailed = false;
+        previous = chunkEnd;
+    }
+}
+
+/* @breif: Memory maps a submission file, parses it on several threads and
+ * splices the resulting tasks into the queue in a single operation.
+ * @currentTaskQueueHead: The current head of the global task queue.
+ * @filePath: Path of the text or binary submission file.
+ * @nextTaskID: Next task ID, advanced past the ingested tasks.
+ * @nextWorkUnits: Next simulated work units value, advanced likewise.
+ * @threadCount: Number of parser threads, 0 for one per hardware thread.
+ * @Return: task* - The updated head of the task queue.
+ */
+task *dtkIngest(task *currentTaskQueueHead, const std::string &filePath,
+                int *nextTaskID, int *nextWorkUnits, unsigned int threadCount) {
+    std::cout << "[INFO]: Ingesting tasks from " << filePath << " ...\n";
+    auto startTime = std::chrono::steady_clock::now();
+
+    int fd = open(filePath.c_str(), O_RDONLY);
+    if(fd < 0) {
+        std::cout << "[ERROR]: Unable to open " << filePath << ": "
+                  << std::strerror(errno) << "\n";
+        return currentTaskQueueHead;
+    }
+
+    struct stat fileInfo;
+    if(fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0) {
+        std::cout << "[ERROR]: " << filePath << " is empty or unreadable.\n";
+        close(fd);
+        return currentTaskQueueHead;
+    }
+    size_t fileSize = (size_t)fileInfo.st_size;
+
+    void *mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+    if(mapping == MAP_FAILED) {
+        std::cout << "[ERROR]: Unable to map " << filePath << ": "
+                  << std::strerror(errno) << "\n";
+        return currentTaskQueueHead;
+    }
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    const char *begin = static_cast<const char *>(mapping);
+    const char *end = begin + fileSize;
+    bool isBinary = fileSize >= INGEST_MAGIC_SIZE &&
+                    std::memcmp(begin, INGEST_MAGIC, INGEST_MAGIC_SIZE) == 0;
+    if(isBinary)
+        begin += INGEST_MAGIC_SIZE;
+
+    // one chunk per hardware thread, but never smaller than the minimum
+    if(threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if(threadCount == 0)
+        threadCount = 1;
+    size_t maxChunks = (size_t)(end - begin) / INGEST_MIN_CHUNK_SIZE + 1;
+    if(threadCount > maxChunks)
+        threadCount = (unsigned int)maxChunks;
+
+    std::vector<ingestChunk> chunks(threadCount);
+    splitChunks(chunks, begin, end, isBinary);
+
+    std::atomic<size_t> bytesParsed(0);
+    std::atomic<size_t> threadsDone(0);
+    auto parseChunk = [&chunks, &bytesParsed, &threadsDone, isBinary](size_t i) {
+        if(isBinary)
+            parseBinaryChunk(&chunks[i], &bytesParsed);
+        else
+            parseTextChunk(&chunks[i], &bytesParsed);
+        threadsDone.fetch_add(1, std::memory_order_release);
+    };
+
+    std::vector<std::thread> workers;
+    size_t started = 0;
+    try {
+        workers.reserve(threadCount);
+        for(; started < threadCount; started++)
+            workers.emplace_back(parseChunk, started);
+    } catch (const std::system_error &err) {
+        std::cout << "[WARNING]: Started only " << started << " of " << threadCount
+                  << " ingest threads (" << err.what()
+                  << "), parsing the rest on this thread.\n";
+    } catch (const std::bad_alloc &) {
+        std::cout << "[WARNING]: No memory for ingest threads, parsing on this thread.\n";
+    }
+    // chunks without a worker are parsed here while the workers run
+    for(size_t i = started; i < threadCount; i++)
+        parseChunk(i);
+
+    // report progress while the parser threads are running, polling often
+    // enough that small files do not wait for a full report interval
+    size_t totalBytes = (size_t)(end - begin);
+    auto lastReport = std::chrono::steady_clock::now();
+    while(threadsDone.load(std::memory_order_acquire) < threadCount) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(INGEST_POLL_MS));
+        auto now = std::chrono::steady_clock::now();
+        if(now - lastReport < std::chrono::milliseconds(INGEST_REPORT_MS))
+            continue;
+        lastReport = now;
+        size_t parsed = bytesParsed.load(std::memory_order_relaxed);
+        std::cout << "[INFO]: Ingest progress: "
+                  << (totalBytes ? parsed * 100 / totalBytes : 100) << "% ("
+                  << parsed << "/" << totalBytes << " bytes)\n";
+    }
+    for(std::thread &worker : workers)
+        worker.join();
+    munmap(mapping, fileSize);
+
+    bool allocFailed = false;
+    for(const ingestChunk &chunk : chunks)
+        allocFailed = allocFailed || chunk.allocFailed;
+    if(allocFailed) {
+        std::cout << "[ERROR]: Failed to allocate memory for ingested tasks."
+                     "System might be out of resources, nothing was queued.\n";
+        for(const ingestChunk &chunk : chunks) {
+            task *current = chunk.head;
+            while(current != nullptr) {
+                task *nextTask = current->next;
+                delete current;
+                current = nextTask;
+            }
+        }
+        return currentTaskQueueHead;
+    }
+
+    // chain the chunks in file order and hand out IDs sequentially
+    task *listHead = nullptr;
+    task *listTail = nullptr;
+    size_t accepted = 0;
+    size_t rejected = 0;
+    for(const ingestChunk &chunk : chunks) {
+        for(task *current = chunk.head; current != nullptr; current = current->next) {
+            current->taskID = (*nextTaskID)++;
+            current->simulatedWorkUnits = (*nextWorkUnits)++;
+        }
+        if(chunk.head != nullptr) {
+            if(listTail == nullptr)
+                listHead = chunk.head;
+            else
+                listTail->next = chunk.head;
+            listTail = chunk.tail;
+        }
+        accepted += chunk.accepted;
+        rejected += chunk.rejected;
+    }
+
+    currentTaskQueueHead = spliceTaskList(currentTaskQueueHead, listHead, listTail);
+
+    double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "[INFO]: Ingested " << accepted << " tasks ("
+              << rejected << " rejected) from " << (isBinary ? "binary" : "text")
+              << " file on " << threadCount << " thread(s) in "
+              << (long long)(seconds * 1000) << " ms";
+    if(seconds > 0)
+        std::cout << " (" << (long long)(accepted / seconds) << " tasks/s)";
+    std::cout << ".\n";
+
+    return currentTaskQueueHead;
+}
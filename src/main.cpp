@@ -40,7 +40,8 @@ int main(void) {
         std::cout << GREEN << "DTK-" << userName << " $ " << RESET;
         /* DTK commands:
          * 1. submit <TaskType> <InputData> [ submit a job ]
-         * 2. shutdown [shutdown DTK]
+         * 2. ingest <File> [bulk load jobs from a submission file]
+         * 3. shutdown [shutdown DTK]
          */
         std::string userInput;
         std::getline(std::cin, userInput);
@@ -125,6 +126,24 @@ int main(void) {
              */
             taskQueueHead = dtkScheduler(taskQueueHead, nodePool);
 
+        } else if(command == "ingest") {
+            std::string filePathStr;
+            ss >> filePathStr;
+
+            if (filePathStr.empty()) {
+                std::cout << "[ERROR]: Invalid ingest command format."
+                             "Usage: ingest <File>\n";
+                continue; // Skip to the next loop iteration
+            }
+
+            /* the file is parsed in parallel and all of its tasks are
+             * spliced into the queue at once, the scheduler is then
+             * called a single time just like after a submit
+             */
+            taskQueueHead = dtkIngest(taskQueueHead, filePathStr,
+                                      &newTaskID, &simulatedWorkUnits);
+            taskQueueHead = dtkScheduler(taskQueueHead, nodePool);
+
         } else if(command == "status") {
             /* status will take the taskQueueHead and nodePool
              * to get the data of nodes and tasks that are currently
@@ -135,6 +154,7 @@ int main(void) {
         } else if(command == "help") {
             // get information on all commands
             std::cout << "[INFO]: submit <job-type> <input-data>, submit a job with valid input data\n"; 
+            std::cout << "[INFO]: ingest <file>, bulk load jobs from a text or binary submission file\n";
             std::cout << "[INFO]: continue <no-params>, moves progress of a task by x units\n";
             std::cout << "[INFO]: status <no-params>, status of current nodes their tasks\n";
             std::cout << "[INFO]: shutdown <no-params>, delete all nodes and tasks assigned\n";
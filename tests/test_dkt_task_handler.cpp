@@ -1,8 +1,212 @@
 #include "dtk_kernel.hpp"
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #define CLEANUPTASKQUEUE 0
+// enough threads to split the ingest files below into several chunks
+#define INGEST_TEST_THREADS 7
+
+static int failedChecks = 0;
+
+// prints the result of a check and counts the failures for the exit code
+static void check(bool condition, const std::string &what) {
+    std::cout << (condition ? "[PASS]: " : "[FAIL]: ") << what << std::endl;
+    if(!condition)
+        failedChecks++;
+}
+
+static task *makeTask(int taskID) {
+    task *newTask = new task;
+    newTask->taskID = taskID;
+    newTask->task = JOB_A;
+    newTask->status = PENDING;
+    newTask->inputData = "data_" + std::to_string(taskID);
+    newTask->resultData = "";
+    newTask->simulatedProgress = 0;
+    newTask->simulatedWorkUnits = 0;
+    newTask->next = nullptr;
+    return newTask;
+}
+
+// builds a linked list of tasks with consecutive IDs, tail is returned through 'tail'
+static task *makeTaskList(int firstID, int count, task **tail) {
+    task *head = nullptr;
+    *tail = nullptr;
+    for(int i = 0; i < count; i++) {
+        task *newTask = makeTask(firstID + i);
+        if(*tail == nullptr)
+            head = newTask;
+        else
+            (*tail)->next = newTask;
+        *tail = newTask;
+    }
+    return head;
+}
+
+/* checks that the queue holds exactly the tasks in 'expectedData' in order,
+ * with IDs and simulated work units counting up from the given values
+ */
+static void checkIngestedQueue(task *head, const std::vector<std::string> &expectedData,
+                               const std::vector<taskType> &expectedTypes,
+                               int firstID, int firstWorkUnits, const std::string &what) {
+    size_t count = 0;
+    bool inOrder = true;
+    for(task *current = head; current != nullptr; current = current->next, count++) {
+        if(count >= expectedData.size() ||
+           current->inputData != expectedData[count] ||
+           current->task != expectedTypes[count] ||
+           current->status != PENDING ||
+           current->taskID != firstID + (int)count ||
+           current->simulatedWorkUnits != firstWorkUnits + (int)count) {
+            if(inOrder && count < expectedData.size())
+                std::cout << "[INFO]: First mismatch at index " << count << ": got \""
+                          << current->inputData << "\", expected \""
+                          << expectedData[count] << "\"\n";
+            inOrder = false;
+        }
+    }
+    check(count == expectedData.size(), what + ": task count " + std::to_string(count)
+          + " == " + std::to_string(expectedData.size()));
+    check(inOrder, what + ": tasks, IDs and work units are in file order");
+}
+
+static void testSpliceTaskList() {
+    std::cout << "\n--- Starting Task List Splice Test ---\n";
+    task *listTail = nullptr;
+    task *listHead = nullptr;
+
+    // splice into an empty queue, the list becomes the queue
+    listHead = makeTaskList(1, 3, &listTail);
+    listTail->next = makeTask(99); // stale link that the splice must reset
+    task *dangling = listTail->next;
+    task *head = spliceTaskList(nullptr, listHead, listTail);
+    delete dangling;
+    check(head == listHead, "splice into empty queue returns the list head");
+    check(listTail->next == nullptr, "splice into empty queue resets the tail's next");
+
+    // splice onto a non empty queue, the list is appended in order
+    task *secondTail = nullptr;
+    task *secondHead = makeTaskList(4, 2, &secondTail);
+    task *sameHead = spliceTaskList(head, secondHead, secondTail);
+    check(sameHead == head, "splice onto non empty queue keeps the head");
+    bool inOrder = true;
+    int expectedID = 1;
+    task *last = nullptr;
+    for(task *current = head; current != nullptr; current = current->next) {
+        inOrder = inOrder && current->taskID == expectedID++;
+        last = current;
+    }
+    check(inOrder && expectedID == 6, "spliced queue holds tasks 1..5 in order");
+    check(last == secondTail && secondTail->next == nullptr, "spliced queue ends at the list tail");
+
+    // an empty list leaves the queue untouched
+    check(spliceTaskList(head, nullptr, nullptr) == head, "splice of an empty list keeps the head");
+    check(spliceTaskList(nullptr, nullptr, nullptr) == nullptr, "splice of an empty list into empty queue");
+
+    cleanUpTaskQueue(head);
+    std::cout << "--- End of Task List Splice Test ---\n";
+}
+
+static void testIngestText() {
+    std::cout << "\n--- Starting Text Ingest Test ---\n";
+    const char *path = "dtk_ingest_test.txt";
+    std::vector<std::string> expectedData;
+    std::vector<taskType> expectedTypes;
+    const taskType types[] = {JOB_A, JOB_B, JOB_C, JOB_D};
+    const char *typeNames[] = {"JOB_A", "JOB_B", "JOB_C", "JOB_D"};
+
+    /* large enough to be split into several chunks, with lines of varying
+     * length so the nominal split points land in the middle of lines
+     */
+    std::ofstream out(path, std::ios::binary);
+    out << "# bulk ingest regression file\n\n";
+    for(int i = 0; i < 60000; i++) {
+        std::string data = "d" + std::to_string(i) + std::string(i % 13, 'x');
+        if(i % 1000 == 0)
+            out << "# JOB_A not_a_task_" << i << "\n";   // comments are skipped
+        if(i % 997 == 0)
+            out << "JOB_E unsupported\nJOB_A\n";          // rejected lines
+        if(i % 2 == 0)
+            out << "submit ";
+        out << typeNames[i % 4] << " " << data;
+        out << (i % 3 == 0 ? "\r\n" : "\n");             // mixed line endings
+        expectedData.push_back(data);
+        expectedTypes.push_back(types[i % 4]);
+    }
+    // last line without a trailing newline
+    out << "  JOB_D last_line";
+    expectedData.push_back("last_line");
+    expectedTypes.push_back(JOB_D);
+    out.close();
+
+    int nextTaskID = 10;
+    int nextWorkUnits = 5;
+    task *head = dtkIngest(nullptr, path, &nextTaskID, &nextWorkUnits, INGEST_TEST_THREADS);
+    checkIngestedQueue(head, expectedData, expectedTypes, 10, 5, "text ingest");
+    check(nextTaskID == 10 + (int)expectedData.size(), "text ingest advances the task ID counter");
+    check(nextWorkUnits == 5 + (int)expectedData.size(), "text ingest advances the work units counter");
+
+    // a second ingest is appended behind the first one
+    std::ofstream small(path, std::ios::binary);
+    small << "# only one task\r\nsubmit JOB_B tail_task";
+    small.close();
+    head = dtkIngest(head, path, &nextTaskID, &nextWorkUnits, INGEST_TEST_THREADS);
+    expectedData.push_back("tail_task");
+    expectedTypes.push_back(JOB_B);
+    checkIngestedQueue(head, expectedData, expectedTypes, 10, 5, "second text ingest");
+
+    cleanUpTaskQueue(head);
+    std::remove(path);
+    std::cout << "--- End of Text Ingest Test ---\n";
+}
+
+static void testIngestBinary() {
+    std::cout << "\n--- Starting Binary Ingest Test ---\n";
+    const char *path = "dtk_ingest_test.bin";
+    std::vector<std::string> expectedData;
+    std::vector<taskType> expectedTypes;
+
+    std::ofstream out(path, std::ios::binary);
+    out.write("DTKB", 4);
+    for(int i = 0; i < 20000; i++) {
+        char record[DTK_INGEST_RECORD_SIZE] = {0};
+        std::string data = "bin" + std::to_string(i);
+        if(i % 500 == 0)
+            data.resize(DTK_INGEST_RECORD_SIZE - 1, 'y');  // full record, no NUL
+        record[0] = (char)(i % 4);
+        data.copy(record + 1, data.size());
+        if(i % 777 == 0) {
+            record[0] = 9;                                // unknown type, rejected
+        } else {
+            expectedData.push_back(data);
+            expectedTypes.push_back((taskType)(i % 4));
+        }
+        out.write(record, DTK_INGEST_RECORD_SIZE);
+    }
+    // truncated last record is rejected
+    out.write("\x01partial", 8);
+    out.close();
+
+    int nextTaskID = 1;
+    int nextWorkUnits = 5;
+    task *head = dtkIngest(nullptr, path, &nextTaskID, &nextWorkUnits, INGEST_TEST_THREADS);
+    checkIngestedQueue(head, expectedData, expectedTypes, 1, 5, "binary ingest");
+
+    cleanUpTaskQueue(head);
+    std::remove(path);
+
+    // a missing file leaves the queue unchanged
+    task *listTail = nullptr;
+    task *queue = makeTaskList(1, 2, &listTail);
+    check(dtkIngest(queue, "dtk_ingest_missing.txt", &nextTaskID, &nextWorkUnits) == queue &&
+          listTail->next == nullptr, "ingest of a missing file keeps the queue");
+    cleanUpTaskQueue(queue);
+    std::cout << "--- End of Binary Ingest Test ---\n";
+}
 
 int main(void) {
 
@@ -82,5 +286,11 @@ int main(void) {
         std::cout << "--- End of Task Queue Functional Test ---\n\n";
         // --- End of Task Queue Testing Block ---
     }
-    return 0;
+
+    testSpliceTaskList();
+    testIngestText();
+    testIngestBinary();
+
+    std::cout << "\n" << failedChecks << " check(s) failed\n";
+    return failedChecks == 0 ? 0 : 1;
 }